@@ -3,6 +3,8 @@
 #include <QGraphicsRectItem>
 #include <QGraphicsTextItem>
 #include <QGraphicsLineItem>
+#include <QGraphicsSimpleTextItem>
+#include <QPair>
 #include <QPen>
 #include <QBrush>
 #include <QFontMetrics>
@@ -11,6 +13,9 @@
 #include <QGraphicsDropShadowEffect>
 #include <QMouseEvent>
 
+// QGraphicsItem::data() key holding a process node's name
+static const int ProcessNameKey = 0;
+
 GraphWidget::GraphWidget(QWidget *parent)
     : QGraphicsView(parent)
 {
@@ -29,6 +34,10 @@ GraphWidget::GraphWidget(QWidget *parent)
 
     // Set a default scene rect (adjust as needed)
     m_scene->setSceneRect(0, 0, 800, 600);
+
+    // Deliver move events without a button held so hovering can be tracked;
+    // the viewport, not the view itself, is what receives them
+    viewport()->setMouseTracking(true);
 }
 
 GraphWidget::~GraphWidget()
@@ -37,10 +46,49 @@ GraphWidget::~GraphWidget()
 }
 
 void GraphWidget::addProcessNode(const QString &processName)
+{
+    // Structural edits work on the full graph, so leave condensation mode first
+    expandAll();
+
+    // Position the ellipse in the scene and store it in the map
+    QGraphicsEllipseItem *ellipse = createProcessItem(processName, getNextProcessPosition(), Qt::cyan);
+    processNodes[processName] = ellipse;
+    processCount++;
+}
+
+void GraphWidget::addResourceNode(const QString &resourceName)
+{
+    expandAll();
+
+    // Position the rectangle in the scene and store it in the map
+    QGraphicsRectItem *rect = createResourceItem(resourceName, getNextResourcePosition(), Qt::yellow);
+    resourceNodes[resourceName] = rect;
+    resourceCount++;
+}
+
+void GraphWidget::addRequestEdge(const QString &processName, const QString &resourceName)
+{
+    expandAll();
+    if (!processNodes.contains(processName) || !resourceNodes.contains(resourceName))
+        return;
+
+    createRequestLine(processNodes.value(processName), resourceNodes.value(resourceName));
+}
+
+void GraphWidget::addAllocationEdge(const QString &processName, const QString &resourceName)
+{
+    expandAll();
+    if (!processNodes.contains(processName) || !resourceNodes.contains(resourceName))
+        return;
+
+    createAllocationLine(processNodes.value(processName), resourceNodes.value(resourceName));
+}
+
+QGraphicsEllipseItem *GraphWidget::createProcessItem(const QString &processName, const QPointF &pos, const QColor &color)
 {
     // Create an ellipse for the process node
     QGraphicsEllipseItem *ellipse = new QGraphicsEllipseItem(0, 0, 60, 60);
-    ellipse->setBrush(Qt::cyan);  // Default color for processes
+    ellipse->setBrush(color);
 
     // Optional: Add a drop shadow effect
     QGraphicsDropShadowEffect *shadowEffect = new QGraphicsDropShadowEffect();
@@ -63,21 +111,19 @@ void GraphWidget::addProcessNode(const QString &processName)
     qreal yOffset = (ellipse->rect().height() - textRect.height()) / 2;
     text->setPos(xOffset, yOffset);
 
-    // Position the ellipse in the scene
-    QPointF pos = getNextProcessPosition();
+    // Tag the ellipse so hover lookups need no map search
+    ellipse->setData(ProcessNameKey, processName);
+
     ellipse->setPos(pos);
     m_scene->addItem(ellipse);
-
-    // Store it in the map
-    processNodes[processName] = ellipse;
-    processCount++;
+    return ellipse;
 }
 
-void GraphWidget::addResourceNode(const QString &resourceName)
+QGraphicsRectItem *GraphWidget::createResourceItem(const QString &resourceName, const QPointF &pos, const QColor &color)
 {
     // Create a rectangle for the resource node
     QGraphicsRectItem *rect = new QGraphicsRectItem(0, 0, 60, 60);
-    rect->setBrush(Qt::yellow);  // Default color for resources
+    rect->setBrush(color);
 
     // Optional: Add a drop shadow effect
     QGraphicsDropShadowEffect *shadowEffect = new QGraphicsDropShadowEffect();
@@ -100,24 +146,13 @@ void GraphWidget::addResourceNode(const QString &resourceName)
     qreal yOffset = (rect->rect().height() - textRect.height()) / 2;
     text->setPos(xOffset, yOffset);
 
-    // Position the rectangle in the scene
-    QPointF pos = getNextResourcePosition();
     rect->setPos(pos);
     m_scene->addItem(rect);
-
-    // Store it in the map
-    resourceNodes[resourceName] = rect;
-    resourceCount++;
+    return rect;
 }
 
-void GraphWidget::addRequestEdge(const QString &processName, const QString &resourceName)
+void GraphWidget::createRequestLine(QGraphicsEllipseItem *pItem, QGraphicsRectItem *rItem)
 {
-    if (!processNodes.contains(processName) || !resourceNodes.contains(resourceName))
-        return;
-
-    QGraphicsEllipseItem *pItem = processNodes.value(processName);
-    QGraphicsRectItem *rItem = resourceNodes.value(resourceName);
-
     QPointF pCenter = pItem->sceneBoundingRect().center();
     QPointF rCenter = rItem->sceneBoundingRect().center();
 
@@ -125,16 +160,11 @@ void GraphWidget::addRequestEdge(const QString &processName, const QString &reso
     QGraphicsLineItem *line = new QGraphicsLineItem(QLineF(pCenter, rCenter));
     line->setPen(QPen(Qt::blue, 2, Qt::DashLine));
     m_scene->addItem(line);
+    edgeLines.insert(line, QPair<QGraphicsItem*, QGraphicsItem*>(pItem, rItem));
 }
 
-void GraphWidget::addAllocationEdge(const QString &processName, const QString &resourceName)
+void GraphWidget::createAllocationLine(QGraphicsEllipseItem *pItem, QGraphicsRectItem *rItem)
 {
-    if (!processNodes.contains(processName) || !resourceNodes.contains(resourceName))
-        return;
-
-    QGraphicsEllipseItem *pItem = processNodes.value(processName);
-    QGraphicsRectItem *rItem = resourceNodes.value(resourceName);
-
     QPointF pCenter = pItem->sceneBoundingRect().center();
     QPointF rCenter = rItem->sceneBoundingRect().center();
 
@@ -142,6 +172,7 @@ void GraphWidget::addAllocationEdge(const QString &processName, const QString &r
     QGraphicsLineItem *line = new QGraphicsLineItem(QLineF(rCenter, pCenter));
     line->setPen(QPen(Qt::green, 2, Qt::SolidLine));
     m_scene->addItem(line);
+    edgeLines.insert(line, QPair<QGraphicsItem*, QGraphicsItem*>(pItem, rItem));
 }
 
 void GraphWidget::highlightProcess(const QString &processName, const QColor &color)
@@ -162,8 +193,355 @@ void GraphWidget::resetProcessColors()
     }
 }
 
+void GraphWidget::highlightChain(const BlockingChain &chain)
+{
+    clearChainHighlight();
+
+    QPen pen(QColor("#ff9800"), 4);  // Orange outline
+    for (const QString &name : chain.processes) {
+        if (QGraphicsEllipseItem *ellipse = processNodes.value(name))
+            chainItems.append(ellipse);
+    }
+    for (const QString &name : chain.resources) {
+        if (QGraphicsRectItem *rect = resourceNodes.value(name))
+            chainItems.append(rect);
+    }
+    for (QAbstractGraphicsShapeItem *item : chainItems)
+        item->setPen(pen);
+}
+
+void GraphWidget::clearChainHighlight()
+{
+    for (QAbstractGraphicsShapeItem *item : chainItems)
+        item->setPen(QPen());
+    chainItems.clear();
+}
+
+void GraphWidget::condense(const QList<NodeGroup> &groups,
+                           const QMap<QString, QSet<QString>> &requests,
+                           const QMap<QString, QSet<QString>> &allocations)
+{
+    expandAll();
+    if (groups.isEmpty())
+        return;
+
+    setUpdatesEnabled(false);
+    condensedRequests = requests;
+    condensedAllocations = allocations;
+
+    // Hide the members, then every edge touching one; the rest stay as they are
+    for (const NodeGroup &group : groups) {
+        QGraphicsRectItem *superNode = createSuperNode(group);
+        if (superNode)
+            superNodes.insert(superNode, group);
+    }
+    updateEdgeLineVisibility();
+    rebuildAggregateEdges();
+    setUpdatesEnabled(true);
+}
+
+void GraphWidget::expandAll()
+{
+    if (superNodes.isEmpty())
+        return;
+
+    // Tear everything down in one pass rather than expanding group by group
+    setUpdatesEnabled(false);
+    for (auto it = superNodes.constBegin(); it != superNodes.constEnd(); ++it) {
+        for (const QString &name : it.value().processes) {
+            if (QGraphicsEllipseItem *ellipse = processNodes.value(name))
+                ellipse->setVisible(true);
+        }
+        for (const QString &name : it.value().resources) {
+            if (QGraphicsRectItem *rect = resourceNodes.value(name))
+                rect->setVisible(true);
+        }
+        m_scene->removeItem(it.key());
+        delete it.key();
+    }
+    superNodes.clear();
+
+    clearAggregateEdges();
+    for (auto it = edgeLines.constBegin(); it != edgeLines.constEnd(); ++it)
+        it.key()->setVisible(true);
+    condensedRequests.clear();
+    condensedAllocations.clear();
+    setUpdatesEnabled(true);
+}
+
+QGraphicsRectItem *GraphWidget::createSuperNode(const NodeGroup &group)
+{
+    // Place the super-node at the centroid of its members and hide them
+    QPointF centroid;
+    int members = 0;
+    for (const QString &name : group.processes) {
+        if (QGraphicsEllipseItem *ellipse = processNodes.value(name)) {
+            centroid += ellipse->pos();
+            ellipse->setVisible(false);
+            ++members;
+        }
+    }
+    for (const QString &name : group.resources) {
+        if (QGraphicsRectItem *rect = resourceNodes.value(name)) {
+            centroid += rect->pos();
+            rect->setVisible(false);
+            ++members;
+        }
+    }
+    if (members == 0)
+        return nullptr;
+    centroid /= members;
+
+    // Create a larger rectangle for the super-node
+    QGraphicsRectItem *rect = new QGraphicsRectItem(0, 0, 90, 60);
+    rect->setBrush(QColor("#ab47bc"));  // Purple for collapsed groups
+    rect->setPen(QPen(Qt::white, 2));
+
+    // Label with the group name and member count
+    QGraphicsTextItem *text = new QGraphicsTextItem(tr("%1\n(%2)").arg(group.label).arg(members), rect);
+    QFont font = text->font();
+    font.setPointSize(9);
+    font.setBold(true);
+    text->setFont(font);
+    text->setDefaultTextColor(Qt::white);
+    text->setTextWidth(rect->rect().width());
+    text->setPos(0, (rect->rect().height() - text->boundingRect().height()) / 2);
+
+    rect->setPos(centroid);
+    m_scene->addItem(rect);
+    return rect;
+}
+
+void GraphWidget::expandGroup(QGraphicsRectItem *superNode)
+{
+    NodeGroup group = superNodes.take(superNode);
+    m_scene->removeItem(superNode);
+    delete superNode;
+
+    for (const QString &name : group.processes) {
+        if (QGraphicsEllipseItem *ellipse = processNodes.value(name))
+            ellipse->setVisible(true);
+    }
+    for (const QString &name : group.resources) {
+        if (QGraphicsRectItem *rect = resourceNodes.value(name))
+            rect->setVisible(true);
+    }
+
+    // Edges between now-visible nodes come back; the aggregates are redrawn
+    updateEdgeLineVisibility();
+    if (!superNodes.isEmpty()) {
+        rebuildAggregateEdges();
+        return;
+    }
+
+    // Last group expanded: nothing is aggregated any more
+    clearAggregateEdges();
+    condensedRequests.clear();
+    condensedAllocations.clear();
+}
+
+void GraphWidget::updateEdgeLineVisibility()
+{
+    // A real edge is shown only while neither of its nodes is collapsed
+    for (auto it = edgeLines.constBegin(); it != edgeLines.constEnd(); ++it)
+        it.key()->setVisible(it.value().first->isVisible() && it.value().second->isVisible());
+}
+
+void GraphWidget::clearAggregateEdges()
+{
+    for (QGraphicsItem *item : aggregateItems) {
+        m_scene->removeItem(item);
+        delete item;
+    }
+    aggregateItems.clear();
+}
+
+void GraphWidget::rebuildAggregateEdges()
+{
+    clearAggregateEdges();
+
+    // Map each collapsed member to the super-node standing in for it
+    QHash<QString, QGraphicsItem*> processOwner;
+    QHash<QString, QGraphicsItem*> resourceOwner;
+    for (auto it = superNodes.constBegin(); it != superNodes.constEnd(); ++it) {
+        for (const QString &name : it.value().processes)
+            processOwner.insert(name, it.key());
+        for (const QString &name : it.value().resources)
+            resourceOwner.insert(name, it.key());
+    }
+
+    // Count edges that touch a super-node per pair of visible endpoints; edges
+    // inside a group vanish and edges between ungrouped nodes keep their own line
+    typedef QPair<QGraphicsItem*, QGraphicsItem*> Endpoints;
+    QHash<Endpoints, int> requestCounts;
+    QHash<Endpoints, int> allocationCounts;
+    auto countEdges = [&](const QMap<QString, QSet<QString>> &edges, QHash<Endpoints, int> &counts) {
+        for (auto it = edges.constBegin(); it != edges.constEnd(); ++it) {
+            QGraphicsItem *pItem = processOwner.value(it.key(), processNodes.value(it.key()));
+            if (!pItem)
+                continue;
+            for (const QString &res : it.value()) {
+                QGraphicsItem *rItem = resourceOwner.value(res, resourceNodes.value(res));
+                if (!rItem || rItem == pItem)
+                    continue;
+                if (processOwner.contains(it.key()) || resourceOwner.contains(res))
+                    counts[qMakePair(pItem, rItem)]++;
+            }
+        }
+    };
+    countEdges(condensedRequests, requestCounts);
+    countEdges(condensedAllocations, allocationCounts);
+
+    // Draw one line per pair, styled like the edges it replaces
+    auto drawEdges = [&](const QHash<Endpoints, int> &counts, const QPen &pen, bool towardsProcess) {
+        for (auto it = counts.constBegin(); it != counts.constEnd(); ++it) {
+            QPointF pCenter = it.key().first->sceneBoundingRect().center();
+            QPointF rCenter = it.key().second->sceneBoundingRect().center();
+            QLineF segment = towardsProcess ? QLineF(rCenter, pCenter) : QLineF(pCenter, rCenter);
+
+            QGraphicsLineItem *line = new QGraphicsLineItem(segment);
+            line->setPen(QPen(pen.color(), pen.widthF() + qMin(it.value() - 1, 4), pen.style()));
+            m_scene->addItem(line);
+            aggregateItems.append(line);
+
+            if (it.value() > 1) {
+                QGraphicsSimpleTextItem *label = new QGraphicsSimpleTextItem(QString::number(it.value()));
+                label->setBrush(Qt::white);
+                label->setPos(segment.center());
+                m_scene->addItem(label);
+                aggregateItems.append(label);
+            }
+        }
+    };
+    drawEdges(requestCounts, QPen(Qt::blue, 2, Qt::DashLine), false);
+    drawEdges(allocationCounts, QPen(Qt::green, 2, Qt::SolidLine), true);
+}
+
+void GraphWidget::clearGraph()
+{
+    // QGraphicsScene::clear() deletes every item, including edges and text labels.
+    m_scene->clear();
+    edgeLines.clear();
+    superNodes.clear();
+    aggregateItems.clear();
+    condensedRequests.clear();
+    condensedAllocations.clear();
+    chainItems.clear();
+    hoveredProcess.clear();
+    processNodes.clear();
+    resourceNodes.clear();
+    processCount = 0;
+    resourceCount = 0;
+}
+
+void GraphWidget::saveLayout(QDataStream &out) const
+{
+    QMap<QString, QPointF> processPositions;
+    QMap<QString, QColor> processColors;
+    for (auto it = processNodes.constBegin(); it != processNodes.constEnd(); ++it) {
+        processPositions.insert(it.key(), it.value()->pos());
+        processColors.insert(it.key(), it.value()->brush().color());
+    }
+
+    QMap<QString, QPointF> resourcePositions;
+    QMap<QString, QColor> resourceColors;
+    for (auto it = resourceNodes.constBegin(); it != resourceNodes.constEnd(); ++it) {
+        resourcePositions.insert(it.key(), it.value()->pos());
+        resourceColors.insert(it.key(), it.value()->brush().color());
+    }
+
+    out << qint32(processCount) << qint32(resourceCount)
+        << processPositions << processColors
+        << resourcePositions << resourceColors;
+}
+
+bool GraphWidget::loadLayout(QDataStream &in,
+                             const QMap<QString, QSet<QString>> &requests,
+                             const QMap<QString, QSet<QString>> &allocations)
+{
+    // Read the whole layout before touching the scene so a corrupt stream changes nothing.
+    qint32 savedProcessCount = 0;
+    qint32 savedResourceCount = 0;
+    QMap<QString, QPointF> processPositions;
+    QMap<QString, QColor> processColors;
+    QMap<QString, QPointF> resourcePositions;
+    QMap<QString, QColor> resourceColors;
+    in >> savedProcessCount >> savedResourceCount
+       >> processPositions >> processColors
+       >> resourcePositions >> resourceColors;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    // Suspend repaints and the BSP index while items are inserted; the index is
+    // rebuilt once at the end instead of being updated for every single item.
+    setUpdatesEnabled(false);
+    m_scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+    clearGraph();
+
+    for (auto it = processPositions.constBegin(); it != processPositions.constEnd(); ++it) {
+        QColor color = processColors.value(it.key(), Qt::cyan);
+        processNodes.insert(it.key(), createProcessItem(it.key(), it.value(), color));
+    }
+    for (auto it = resourcePositions.constBegin(); it != resourcePositions.constEnd(); ++it) {
+        QColor color = resourceColors.value(it.key(), Qt::yellow);
+        resourceNodes.insert(it.key(), createResourceItem(it.key(), it.value(), color));
+    }
+
+    // Resolve each endpoint once per process rather than once per edge
+    for (auto it = requests.constBegin(); it != requests.constEnd(); ++it) {
+        QGraphicsEllipseItem *pItem = processNodes.value(it.key());
+        if (!pItem)
+            continue;
+        for (const QString &resourceName : it.value()) {
+            if (QGraphicsRectItem *rItem = resourceNodes.value(resourceName))
+                createRequestLine(pItem, rItem);
+        }
+    }
+    for (auto it = allocations.constBegin(); it != allocations.constEnd(); ++it) {
+        QGraphicsEllipseItem *pItem = processNodes.value(it.key());
+        if (!pItem)
+            continue;
+        for (const QString &resourceName : it.value()) {
+            if (QGraphicsRectItem *rItem = resourceNodes.value(resourceName))
+                createAllocationLine(pItem, rItem);
+        }
+    }
+
+    processCount = savedProcessCount;
+    resourceCount = savedResourceCount;
+
+    m_scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+    m_scene->setSceneRect(m_scene->itemsBoundingRect().united(QRectF(0, 0, 800, 600)));
+    setUpdatesEnabled(true);
+    return true;
+}
+
+// Helper to turn a node map into a JSON object of {x, y, color} entries
+template <typename Item>
+static QJsonObject nodesToJson(const QMap<QString, Item*> &nodes)
+{
+    QJsonObject object;
+    for (auto it = nodes.constBegin(); it != nodes.constEnd(); ++it) {
+        QJsonObject node;
+        node.insert("x", it.value()->pos().x());
+        node.insert("y", it.value()->pos().y());
+        node.insert("color", it.value()->brush().color().name());
+        object.insert(it.key(), node);
+    }
+    return object;
+}
+
+QJsonObject GraphWidget::layoutToJson() const
+{
+    QJsonObject object;
+    object.insert("processes", nodesToJson(processNodes));
+    object.insert("resources", nodesToJson(resourceNodes));
+    return object;
+}
+
 void GraphWidget::removeProcessNode(const QString &processName)
 {
+    expandAll();
     if (!processNodes.contains(processName))
         return;
 
@@ -173,6 +551,9 @@ void GraphWidget::removeProcessNode(const QString &processName)
 
     // Remove all edges connected to this ellipse
     removeEdgesConnectedTo(ellipse);
+    chainItems.removeAll(ellipse);
+    if (hoveredProcess == processName)
+        hoveredProcess.clear();
 
     // Remove from scene and map
     m_scene->removeItem(ellipse);
@@ -182,6 +563,7 @@ void GraphWidget::removeProcessNode(const QString &processName)
 
 void GraphWidget::removeResourceNode(const QString &resourceName)
 {
+    expandAll();
     if (!resourceNodes.contains(resourceName))
         return;
 
@@ -191,6 +573,7 @@ void GraphWidget::removeResourceNode(const QString &resourceName)
 
     // Remove all edges connected to this rect
     removeEdgesConnectedTo(rect);
+    chainItems.removeAll(rect);
 
     // Remove from scene and map
     m_scene->removeItem(rect);
@@ -201,29 +584,17 @@ void GraphWidget::removeResourceNode(const QString &resourceName)
 // Helper to remove edges connected to a given item
 void GraphWidget::removeEdgesConnectedTo(QGraphicsItem *item)
 {
-    // Remove any QGraphicsLineItem that touches the center of 'item'.
-    QPointF center = item->sceneBoundingRect().center();
-
-    // Collect items to remove to avoid modifying the scene during iteration.
-    QList<QGraphicsItem*> itemsToRemove;
-
-    for (QGraphicsItem *other : m_scene->items()) {
-        QGraphicsLineItem *line = qgraphicsitem_cast<QGraphicsLineItem*>(other);
-        if (!line)
-            continue;
+    // Collect items to remove to avoid modifying the map during iteration.
+    QList<QGraphicsLineItem*> itemsToRemove;
 
-        QPointF p1 = line->line().p1();
-        QPointF p2 = line->line().p2();
-
-        // If either endpoint is close to 'center', mark for removal
-        if ((p1 - center).manhattanLength() < 1.0 ||
-            (p2 - center).manhattanLength() < 1.0) {
-            itemsToRemove << line;
-        }
+    for (auto it = edgeLines.constBegin(); it != edgeLines.constEnd(); ++it) {
+        if (it.value().first == item || it.value().second == item)
+            itemsToRemove << it.key();
     }
 
     // Now remove the collected items from the scene.
-    for (QGraphicsItem *toRemove : itemsToRemove) {
+    for (QGraphicsLineItem *toRemove : itemsToRemove) {
+        edgeLines.remove(toRemove);
         m_scene->removeItem(toRemove);
         delete toRemove;
     }
@@ -234,6 +605,17 @@ void GraphWidget::mousePressEvent(QMouseEvent *event)
     // Convert mouse coordinates to scene coordinates
     QPointF scenePos = mapToScene(event->pos());
     QGraphicsItem *item = m_scene->itemAt(scenePos, QTransform());
+
+    // Clicking a super-node expands its group instead of offering removal
+    if (item) {
+        QGraphicsRectItem *superNode = qgraphicsitem_cast<QGraphicsRectItem*>(item->topLevelItem());
+        if (superNode && superNodes.contains(superNode)) {
+            expandGroup(superNode);
+            event->accept();
+            return;
+        }
+    }
+
     if (item) {
         // Determine whether the clicked item is a process or resource
         for (auto it = processNodes.constBegin(); it != processNodes.constEnd(); ++it) {
@@ -254,6 +636,24 @@ void GraphWidget::mousePressEvent(QMouseEvent *event)
     QGraphicsView::mousePressEvent(event);
 }
 
+void GraphWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    // The hit may be the label, so look at the top-level node item
+    QPointF scenePos = mapToScene(event->pos());
+    QGraphicsItem *item = m_scene->itemAt(scenePos, QTransform());
+    QString name;
+    if (item)
+        name = item->topLevelItem()->data(ProcessNameKey).toString();
+
+    // Only notify when the hovered process actually changes
+    if (name != hoveredProcess) {
+        hoveredProcess = name;
+        emit processHovered(name);
+    }
+
+    QGraphicsView::mouseMoveEvent(event);
+}
+
 QPointF GraphWidget::getNextProcessPosition()
 {
     // Example logic: place processes on the left, spaced vertically.
@@ -9,6 +9,12 @@
 #include <QGraphicsRectItem>
 #include <QMouseEvent>
 #include <QColor>  // Needed for QColor
+#include <QSet>
+#include <QDataStream>
+#include <QJsonObject>
+#include <QHash>
+#include <QPair>
+#include "ResourceAllocationModel.h"  // NodeGroup, BlockingChain
 
 /**
  * @brief The GraphWidget class visualizes processes and resources as nodes and edges.
@@ -36,6 +42,61 @@ public:
     // Reset all process nodes to the default color
     void resetProcessColors();
 
+    /**
+     * @brief Outline every process and resource node in a blocking chain.
+     * Replaces any previous chain highlight.
+     */
+    void highlightChain(const BlockingChain &chain);
+
+    // Remove the outline added by highlightChain()
+    void clearChainHighlight();
+
+    /**
+     * @brief Collapse each group into a single super-node.
+     * Member nodes and the edges touching them are hidden; edges to or from a
+     * super-node are drawn once per pair of endpoints, labelled with how many
+     * edges they stand for. Edges between ungrouped nodes are left alone.
+     * Clicking a super-node expands that group again.
+     * @param groups The groups to collapse; any previous condensation is undone first.
+     * @param requests Requested resources keyed by process name.
+     * @param allocations Allocated resources keyed by process name.
+     */
+    void condense(const QList<NodeGroup> &groups,
+                  const QMap<QString, QSet<QString>> &requests,
+                  const QMap<QString, QSet<QString>> &allocations);
+
+    // Expand every super-node and restore the original edges
+    void expandAll();
+
+    // True while at least one group is collapsed
+    bool isCondensed() const { return !superNodes.isEmpty(); }
+
+    // Remove every node and edge from the scene
+    void clearGraph();
+
+    /**
+     * @brief Serialize node positions and colors to a binary stream.
+     * @param out The stream to write to.
+     */
+    void saveLayout(QDataStream &out) const;
+
+    /**
+     * @brief Rebuild the whole scene from a saved layout and the model's edges.
+     * Items are constructed in one pass with scene indexing and view updates suspended.
+     * @param in The stream to read the layout from.
+     * @param requests Requested resources keyed by process name.
+     * @param allocations Allocated resources keyed by process name.
+     * @return false if the stream is truncated or corrupt; the scene is left unchanged.
+     */
+    bool loadLayout(QDataStream &in,
+                    const QMap<QString, QSet<QString>> &requests,
+                    const QMap<QString, QSet<QString>> &allocations);
+
+    /**
+     * @brief Export node positions and colors as a JSON object.
+     */
+    QJsonObject layoutToJson() const;
+
 signals:
     /**
      * @brief Emitted when the user clicks on a node (process or resource).
@@ -44,12 +105,23 @@ signals:
      */
     void nodeClicked(const QString &name, bool isProcess);
 
+    /**
+     * @brief Emitted when the mouse moves onto or off a process node.
+     * @param name The hovered process, or an empty string when leaving it.
+     */
+    void processHovered(const QString &name);
+
 protected:
     /**
      * @brief Overridden to detect clicks on nodes and emit nodeClicked signal.
      */
     void mousePressEvent(QMouseEvent *event) override;
 
+    /**
+     * @brief Overridden to track which process node is under the mouse.
+     */
+    void mouseMoveEvent(QMouseEvent *event) override;
+
 private:
     QGraphicsScene *m_scene;
 
@@ -57,10 +129,39 @@ private:
     QMap<QString, QGraphicsEllipseItem*> processNodes;
     QMap<QString, QGraphicsRectItem*> resourceNodes;
 
+    // Every request and allocation line in the scene, with its process and resource node
+    QHash<QGraphicsLineItem*, QPair<QGraphicsItem*, QGraphicsItem*>> edgeLines;
+
+    // Condensation state: collapsed groups, the edges they were built from,
+    // and the aggregated edge lines and labels currently drawn
+    QHash<QGraphicsRectItem*, NodeGroup> superNodes;
+    QMap<QString, QSet<QString>> condensedRequests;
+    QMap<QString, QSet<QString>> condensedAllocations;
+    QList<QGraphicsItem*> aggregateItems;
+
+    // Helpers that build a styled node or edge item and add it to the scene
+    QGraphicsEllipseItem *createProcessItem(const QString &processName, const QPointF &pos, const QColor &color);
+    QGraphicsRectItem *createResourceItem(const QString &resourceName, const QPointF &pos, const QColor &color);
+    void createRequestLine(QGraphicsEllipseItem *pItem, QGraphicsRectItem *rItem);
+    void createAllocationLine(QGraphicsEllipseItem *pItem, QGraphicsRectItem *rItem);
+
+    // Helpers for condensation mode
+    QGraphicsRectItem *createSuperNode(const NodeGroup &group);
+    void expandGroup(QGraphicsRectItem *superNode);
+    void rebuildAggregateEdges();
+    void clearAggregateEdges();
+    void updateEdgeLineVisibility();
+
     // Helper functions for positioning nodes
     QPointF getNextProcessPosition();
     QPointF getNextResourcePosition();
 
+    // Nodes currently outlined by highlightChain()
+    QList<QAbstractGraphicsShapeItem*> chainItems;
+
+    // Process node currently under the mouse
+    QString hoveredProcess;
+
     int processCount = 0;
     int resourceCount = 0;
 
@@ -3,7 +3,19 @@
 #include <QInputDialog>
 #include <QLineEdit>
 #include <QMessageBox>
+#include <QStatusBar>
+#include <QMenu>
 #include <QDebug>
+#include <QFileDialog>
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+// Session file header: magic number followed by a format version
+static const quint32 SessionMagic = 0x52414753;  // "RAGS"
+static const quint16 SessionVersion = 1;
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -21,6 +33,15 @@ MainWindow::MainWindow(QWidget *parent)
     // Connect the nodeClicked signal from GraphWidget to our slot
     connect(graphWidget, &GraphWidget::nodeClicked,
             this, &MainWindow::onNodeClicked);
+
+    // Show the blocking chain of whichever process is under the mouse
+    connect(graphWidget, &GraphWidget::processHovered,
+            this, &MainWindow::onProcessHovered);
+
+    // Groups can also be expanded by clicking or by edits, so check on every open
+    connect(ui->menuMenu, &QMenu::aboutToShow, this, [this]() {
+        ui->actionExpandAll->setEnabled(graphWidget->isCondensed());
+    });
 }
 
 MainWindow::~MainWindow()
@@ -40,7 +61,7 @@ void MainWindow::on_actionAddProcess_triggered()
                                                 &ok).trimmed();
     if (ok && !processName.isEmpty()) {
         // Check for duplicate processes
-        if (model->getProcesses().contains(processName)) {
+        if (model->hasProcess(processName)) {
             QMessageBox::warning(this, tr("Duplicate Process"),
                                  tr("Process '%1' already exists.").arg(processName));
             return;
@@ -64,7 +85,7 @@ void MainWindow::on_actionAddResource_triggered()
                                                  &ok).trimmed();
     if (ok && !resourceName.isEmpty()) {
         // Check for duplicate resources
-        if (model->getResources().contains(resourceName)) {
+        if (model->hasResource(resourceName)) {
             QMessageBox::warning(this, tr("Duplicate Resource"),
                                  tr("Resource '%1' already exists.").arg(resourceName));
             return;
@@ -151,6 +172,149 @@ void MainWindow::on_actionDetectDeadlock_triggered()
     }
 }
 
+void MainWindow::on_actionCriticalResources_triggered()
+{
+    QStringList critical = model->criticalResources(5);
+    if (critical.isEmpty()) {
+        QMessageBox::information(this, tr("Critical Resources"),
+                                 tr("No resource is blocking any process."));
+        return;
+    }
+    QMessageBox::information(this, tr("Critical Resources"),
+                             tr("Resources blocking the most processes:\n%1")
+                                 .arg(critical.join("\n")));
+}
+
+void MainWindow::on_actionCondenseCycles_triggered()
+{
+    QList<NodeGroup> groups = model->stronglyConnectedGroups();
+    if (groups.isEmpty()) {
+        QMessageBox::information(this, tr("Condense Cycles"),
+                                 tr("The graph has no cycles to condense."));
+        return;
+    }
+    graphWidget->condense(groups, model->getRequests(), model->getAllocations());
+}
+
+void MainWindow::on_actionCondenseByPrefix_triggered()
+{
+    bool ok;
+    QString separator = QInputDialog::getText(this,
+                                              tr("Condense by Prefix"),
+                                              tr("Group names sharing the text before this separator:"),
+                                              QLineEdit::Normal,
+                                              QStringLiteral("."),
+                                              &ok);
+    if (!ok || separator.isEmpty())
+        return;
+
+    QList<NodeGroup> groups = model->prefixGroups(separator);
+    if (groups.isEmpty()) {
+        QMessageBox::information(this, tr("Condense by Prefix"),
+                                 tr("No names share a prefix before '%1'.").arg(separator));
+        return;
+    }
+    graphWidget->condense(groups, model->getRequests(), model->getAllocations());
+}
+
+void MainWindow::on_actionExpandAll_triggered()
+{
+    graphWidget->expandAll();
+}
+
+void MainWindow::on_actionOpenSession_triggered()
+{
+    QString fileName = QFileDialog::getOpenFileName(this,
+                                                    tr("Open Session"),
+                                                    QString(),
+                                                    tr("RAG Sessions (*.rag)"));
+    if (fileName.isEmpty())
+        return;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        QMessageBox::warning(this, tr("Open Session"),
+                             tr("Cannot open '%1': %2").arg(fileName, file.errorString()));
+        return;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != SessionMagic || version != SessionVersion) {
+        QMessageBox::warning(this, tr("Open Session"),
+                             tr("'%1' is not a supported session file.").arg(fileName));
+        return;
+    }
+
+    // Read the model into a scratch copy first; loadLayout() only touches the
+    // scene once its section has read cleanly, so a corrupt file at either
+    // point leaves the current session as it was.
+    ResourceAllocationModel loaded;
+    if (!loaded.load(in)
+        || !graphWidget->loadLayout(in, loaded.getRequests(), loaded.getAllocations())) {
+        QMessageBox::warning(this, tr("Open Session"),
+                             tr("'%1' is corrupt.").arg(fileName));
+        return;
+    }
+    model->takeFrom(loaded);
+}
+
+void MainWindow::on_actionSaveSession_triggered()
+{
+    QString fileName = QFileDialog::getSaveFileName(this,
+                                                    tr("Save Session"),
+                                                    QString(),
+                                                    tr("RAG Sessions (*.rag)"));
+    if (fileName.isEmpty())
+        return;
+
+    // QSaveFile only replaces the target once everything has been written
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        QMessageBox::warning(this, tr("Save Session"),
+                             tr("Cannot write '%1': %2").arg(fileName, file.errorString()));
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << SessionMagic << SessionVersion;
+    model->save(out);
+    graphWidget->saveLayout(out);
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        QMessageBox::warning(this, tr("Save Session"),
+                             tr("Cannot write '%1': %2").arg(fileName, file.errorString()));
+    }
+}
+
+void MainWindow::on_actionExportJson_triggered()
+{
+    QString fileName = QFileDialog::getSaveFileName(this,
+                                                    tr("Export JSON"),
+                                                    QString(),
+                                                    tr("JSON Files (*.json)"));
+    if (fileName.isEmpty())
+        return;
+
+    QJsonObject session;
+    session.insert("version", int(SessionVersion));
+    session.insert("model", model->toJson());
+    session.insert("layout", graphWidget->layoutToJson());
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(QJsonDocument(session).toJson()) < 0
+        || !file.commit()) {
+        QMessageBox::warning(this, tr("Export JSON"),
+                             tr("Cannot write '%1': %2").arg(fileName, file.errorString()));
+    }
+}
+
 void MainWindow::onNodeClicked(const QString &name, bool isProcess)
 {
     // Ask user for confirmation before removal
@@ -175,3 +339,21 @@ void MainWindow::onNodeClicked(const QString &name, bool isProcess)
                                  tr("The %1 '%2' has been removed.").arg(nodeType).arg(name));
     }
 }
+
+void MainWindow::onProcessHovered(const QString &name)
+{
+    if (name.isEmpty()) {
+        graphWidget->clearChainHighlight();
+        statusBar()->clearMessage();
+        return;
+    }
+
+    // Both queries are memoized by the model, so repeated hovers are cheap
+    BlockingChain chain = model->blockingChain(name);
+    graphWidget->highlightChain(chain);
+    statusBar()->showMessage(tr("Process '%1' waits on %2 processes and %3 resources and blocks %4 processes.")
+                                 .arg(name)
+                                 .arg(chain.processes.size())
+                                 .arg(chain.resources.size())
+                                 .arg(model->blockedBy(name).size()));
+}
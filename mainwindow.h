@@ -26,6 +26,13 @@ private slots:
     void on_actionRequestResource_triggered();
     void on_actionAllocateResource_triggered();
     void on_actionDetectDeadlock_triggered();
+    void on_actionCriticalResources_triggered();
+    void on_actionCondenseCycles_triggered();
+    void on_actionCondenseByPrefix_triggered();
+    void on_actionExpandAll_triggered();
+    void on_actionOpenSession_triggered();
+    void on_actionSaveSession_triggered();
+    void on_actionExportJson_triggered();
 
     /**
      * @brief Slot called when a node in the graph is clicked.
@@ -34,6 +41,12 @@ private slots:
      */
     void onNodeClicked(const QString &name, bool isProcess);
 
+    /**
+     * @brief Slot called when the mouse enters or leaves a process node.
+     * @param name The hovered process, or an empty string.
+     */
+    void onProcessHovered(const QString &name);
+
 private:
     Ui::MainWindow *ui;
     ResourceAllocationModel *model;
@@ -1,4 +1,9 @@
 #include "ResourceAllocationModel.h"
+#include <QJsonArray>
+#include <QStringList>
+#include <QVector>
+#include <QPair>
+#include <algorithm>
 
 ResourceAllocationModel::ResourceAllocationModel(QObject *parent)
     : QObject(parent)
@@ -7,7 +12,11 @@ ResourceAllocationModel::ResourceAllocationModel(QObject *parent)
 
 void ResourceAllocationModel::addProcess(const QString &processName)
 {
+    if (processes.contains(processName))
+        return;
     processes.insert(processName);
+    const int pid = processId(processName);
+    rootProcess[pid] = true;
 }
 
 void ResourceAllocationModel::addResource(const QString &resourceName)
@@ -17,14 +26,44 @@ void ResourceAllocationModel::addResource(const QString &resourceName)
 
 void ResourceAllocationModel::requestResource(const QString &processName, const QString &resourceName)
 {
-    requests[processName].insert(resourceName);
+    QSet<QString> &requested = requests[processName];
+    if (!requested.contains(resourceName)) {
+        requested.insert(resourceName);
+        const int pid = processId(processName);
+        const int rid = resourceId(resourceName);
+        requestedIds[pid].append(rid);
+    }
+    waiters[resourceName].insert(processName);
+
+    // processName now waits on every current holder of the resource
+    invalidateChains(processName);
+    for (const QString &holder : holders.value(resourceName))
+        invalidateBlocked(holder);
 }
 
 void ResourceAllocationModel::allocateResource(const QString &processName, const QString &resourceName)
 {
-    allocations[processName].insert(resourceName);
-    if (requests.contains(processName))
-        requests[processName].remove(resourceName);
+    // Every process requesting the resource now waits on processName
+    for (const QString &waiter : waiters.value(resourceName))
+        invalidateChains(waiter);
+    invalidateBlocked(processName);
+
+    const int pid = processId(processName);
+    const int rid = resourceId(resourceName);
+    QSet<QString> &allocated = allocations[processName];
+    if (!allocated.contains(resourceName)) {
+        allocated.insert(resourceName);
+        holderIds[rid].append(pid);
+    }
+    holders[resourceName].insert(processName);
+    if (requests.contains(processName) && requests[processName].remove(resourceName)) {
+        // The satisfied request no longer makes processName wait on the other holders
+        requestedIds[pid].removeOne(rid);
+        waiters[resourceName].remove(processName);
+        invalidateChains(processName);
+        for (const QString &holder : holders.value(resourceName))
+            invalidateBlocked(holder);
+    }
 }
 
 void ResourceAllocationModel::removeProcess(const QString &processName)
@@ -36,8 +75,26 @@ void ResourceAllocationModel::removeProcess(const QString &processName)
     processes.remove(processName);
 
     // Remove any requests or allocations associated with this process
+    const int pid = processIndex.value(processName);
+    for (const QString &res : requests.value(processName))
+        waiters[res].remove(processName);
+    for (const QString &res : allocations.value(processName)) {
+        holders[res].remove(processName);
+        holderIds[resourceIndex.value(res)].removeOne(pid);
+    }
     requests.remove(processName);
     allocations.remove(processName);
+
+    // Nothing refers to the id any more, so hand it back for reuse
+    requestedIds[pid].clear();
+    rootProcess[pid] = false;
+    indexedProcesses[pid].clear();
+    processIndex.remove(processName);
+    freeProcessIds.append(pid);
+
+    // Removing a node can break any number of chains
+    chainCache.clear();
+    blockedCache.clear();
 }
 
 void ResourceAllocationModel::removeResource(const QString &resourceName)
@@ -48,55 +105,641 @@ void ResourceAllocationModel::removeResource(const QString &resourceName)
     // Remove from the set of resources
     resources.remove(resourceName);
 
-    // Remove this resource from all requests
-    for (auto it = requests.begin(); it != requests.end(); ++it) {
-        it.value().remove(resourceName);
+    // Only the processes that request or hold it need editing
+    const QSet<QString> requesting = waiters.value(resourceName);
+    const QSet<QString> holding = holders.value(resourceName);
+    for (const QString &proc : requesting) {
+        auto it = requests.find(proc);
+        if (it != requests.end())
+            it.value().remove(resourceName);
+    }
+    for (const QString &proc : holding) {
+        auto it = allocations.find(proc);
+        if (it != allocations.end())
+            it.value().remove(resourceName);
     }
 
-    // Remove this resource from all allocations
-    for (auto it = allocations.begin(); it != allocations.end(); ++it) {
-        it.value().remove(resourceName);
+    // Drop the resource from the id-based edges and hand its id back for reuse
+    auto rid = resourceIndex.constFind(resourceName);
+    if (rid != resourceIndex.constEnd()) {
+        const int id = rid.value();
+        holderIds[id].clear();
+        for (const QString &proc : requesting)
+            requestedIds[processIndex.value(proc)].removeOne(id);
+        resourceIndex.remove(resourceName);
+        freeResourceIds.append(id);
     }
+
+    holders.remove(resourceName);
+    waiters.remove(resourceName);
+    chainCache.clear();
+    blockedCache.clear();
 }
 
-bool ResourceAllocationModel::dfs(const QString &process,
-                                  QSet<QString> &visited,
-                                  QSet<QString> &recStack,
-                                  QSet<QString> &cycle) const
+int ResourceAllocationModel::processId(const QString &processName)
 {
-    if (recStack.contains(process)) {
-        cycle = recStack; // Capture the current recursion stack as the cycle.
-        return true;
+    auto found = processIndex.constFind(processName);
+    if (found != processIndex.constEnd())
+        return found.value();
+
+    // Reuse the slot of a removed process first; its arrays are already sized
+    if (!freeProcessIds.isEmpty()) {
+        const int id = freeProcessIds.takeLast();
+        processIndex.insert(processName, id);
+        indexedProcesses[id] = processName;
+        visitedStamp[id] = 0;
+        onStackStamp[id] = 0;
+        return id;
+    }
+
+    // Each process is on the DFS stack at most once, so one frame per id suffices.
+    // Appending grows the arrays geometrically, so new names rarely reallocate.
+    const int id = int(indexedProcesses.size());
+    processIndex.insert(processName, id);
+    indexedProcesses.append(processName);
+    rootProcess.append(false);
+    requestedIds.append(QVector<int>());
+    visitedStamp.append(0);
+    onStackStamp.append(0);
+    scratchStack.append(DetectionFrame());
+    return id;
+}
+
+int ResourceAllocationModel::resourceId(const QString &resourceName)
+{
+    auto found = resourceIndex.constFind(resourceName);
+    if (found != resourceIndex.constEnd())
+        return found.value();
+
+    if (!freeResourceIds.isEmpty()) {
+        const int id = freeResourceIds.takeLast();
+        resourceIndex.insert(resourceName, id);
+        return id;
     }
-    if (visited.contains(process))
-        return false;
 
-    visited.insert(process);
-    recStack.insert(process);
-
-    // For each resource requested by this process...
-    QSet<QString> reqs = requests.value(process);
-    for (const QString &res : reqs) {
-        // For every process that holds this resource...
-        for (auto it = allocations.begin(); it != allocations.end(); ++it) {
-            if (it.value().contains(res)) {
-                if (dfs(it.key(), visited, recStack, cycle))
-                    return true;
+    const int id = int(holderIds.size());
+    resourceIndex.insert(resourceName, id);
+    holderIds.append(QVector<int>());
+    return id;
+}
+
+int ResourceAllocationModel::findCycle(int &depth) const
+{
+    // Start a new generation; on wrap-around, clear the stamps once
+    if (++generation == 0) {
+        visitedStamp.fill(0);
+        onStackStamp.fill(0);
+        generation = 1;
+    }
+
+    // Start a frame at the first request of a process
+    auto push = [this, &depth](int id) {
+        visitedStamp[id] = generation;
+        onStackStamp[id] = generation;
+        DetectionFrame &frame = scratchStack[depth++];
+        frame.process = id;
+        frame.request = 0;
+        frame.resource = -1;
+        frame.holder = 0;
+    };
+
+    depth = 0;
+    const int n = int(indexedProcesses.size());
+    for (int root = 0; root < n; ++root) {
+        if (!rootProcess[root] || visitedStamp[root] == generation)
+            continue;
+        push(root);
+
+        while (depth > 0) {
+            DetectionFrame &frame = scratchStack[depth - 1];
+
+            // Next process holding the current requested resource
+            if (frame.resource >= 0 && frame.holder < holderIds[frame.resource].size()) {
+                const int next = holderIds[frame.resource][frame.holder++];
+                if (onStackStamp[next] == generation) {
+                    // Back edge: the cycle runs from next to the top of the stack
+                    int start = depth - 1;
+                    while (scratchStack[start].process != next)
+                        --start;
+                    return start;
+                }
+                if (visitedStamp[next] != generation)
+                    push(next);
+                continue;
+            }
+
+            // Move on to the holders of the next requested resource
+            if (frame.request < requestedIds[frame.process].size()) {
+                frame.resource = requestedIds[frame.process][frame.request++];
+                frame.holder = 0;
+                continue;
             }
+
+            // All requests explored: leave the recursion stack
+            onStackStamp[frame.process] = 0;
+            --depth;
         }
     }
-    recStack.remove(process);
-    return false;
+    return -1;
+}
+
+bool ResourceAllocationModel::hasDeadlock() const
+{
+    int depth = 0;
+    return findCycle(depth) >= 0;
 }
 
 QSet<QString> ResourceAllocationModel::detectDeadlockCycle() const
 {
-    QSet<QString> visited;
-    QSet<QString> recStack;
+    int depth = 0;
+    int start = findCycle(depth);
+    if (start < 0)
+        return QSet<QString>();  // No deadlock detected.
+
+    // Only the processes on the cycle itself, not the path that led into it
     QSet<QString> cycle;
-    for (const QString &process : processes) {
-        if (dfs(process, visited, recStack, cycle))
-            return cycle;  // Found a cycle; return the involved processes.
+    for (int i = start; i < depth; ++i)
+        cycle.insert(indexedProcesses[scratchStack[i].process]);
+    return cycle;
+}
+
+void ResourceAllocationModel::clear()
+{
+    processes.clear();
+    resources.clear();
+    requests.clear();
+    allocations.clear();
+    rebuildIndexes();
+}
+
+void ResourceAllocationModel::save(QDataStream &out) const
+{
+    out << processes << resources << requests << allocations;
+}
+
+bool ResourceAllocationModel::load(QDataStream &in)
+{
+    // Read everything into locals first so a corrupt stream leaves the model untouched.
+    QSet<QString> loadedProcesses;
+    QSet<QString> loadedResources;
+    QMap<QString, QSet<QString>> loadedRequests;
+    QMap<QString, QSet<QString>> loadedAllocations;
+    in >> loadedProcesses >> loadedResources >> loadedRequests >> loadedAllocations;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    processes.swap(loadedProcesses);
+    resources.swap(loadedResources);
+    requests.swap(loadedRequests);
+    allocations.swap(loadedAllocations);
+    rebuildIndexes();
+    return true;
+}
+
+void ResourceAllocationModel::takeFrom(ResourceAllocationModel &other)
+{
+    // Swap every container, derived indexes included, so nothing is rebuilt
+    processes.swap(other.processes);
+    resources.swap(other.resources);
+    requests.swap(other.requests);
+    allocations.swap(other.allocations);
+    holders.swap(other.holders);
+    waiters.swap(other.waiters);
+    chainCache.swap(other.chainCache);
+    blockedCache.swap(other.blockedCache);
+    processIndex.swap(other.processIndex);
+    indexedProcesses.swap(other.indexedProcesses);
+    rootProcess.swap(other.rootProcess);
+    requestedIds.swap(other.requestedIds);
+    freeProcessIds.swap(other.freeProcessIds);
+    resourceIndex.swap(other.resourceIndex);
+    holderIds.swap(other.holderIds);
+    freeResourceIds.swap(other.freeResourceIds);
+    visitedStamp.swap(other.visitedStamp);
+    onStackStamp.swap(other.onStackStamp);
+    scratchStack.swap(other.scratchStack);
+    std::swap(generation, other.generation);
+}
+
+void ResourceAllocationModel::rebuildIndexes()
+{
+    // Memoized results depend on the old edges
+    chainCache.clear();
+    blockedCache.clear();
+
+    holders.clear();
+    waiters.clear();
+    processIndex.clear();
+    indexedProcesses.clear();
+    rootProcess.clear();
+    requestedIds.clear();
+    freeProcessIds.clear();
+    resourceIndex.clear();
+    holderIds.clear();
+    freeResourceIds.clear();
+    visitedStamp.clear();
+    onStackStamp.clear();
+    scratchStack.clear();
+    generation = 0;
+
+    for (const QString &proc : processes) {
+        const int pid = processId(proc);
+        rootProcess[pid] = true;
+    }
+    for (auto it = requests.constBegin(); it != requests.constEnd(); ++it) {
+        const int pid = processId(it.key());
+        for (const QString &res : it.value()) {
+            waiters[res].insert(it.key());
+            const int rid = resourceId(res);
+            requestedIds[pid].append(rid);
+        }
+    }
+    for (auto it = allocations.constBegin(); it != allocations.constEnd(); ++it) {
+        const int pid = processId(it.key());
+        for (const QString &res : it.value()) {
+            holders[res].insert(it.key());
+            const int rid = resourceId(res);
+            holderIds[rid].append(pid);
+        }
+    }
+}
+
+void ResourceAllocationModel::invalidateChains(const QString &processName)
+{
+    // A chain is affected by a new or removed wait edge out of processName only
+    // if it starts at processName or already passes through it.
+    for (auto it = chainCache.begin(); it != chainCache.end();) {
+        if (it.key() == processName || it.value().processes.contains(processName))
+            it = chainCache.erase(it);
+        else
+            ++it;
+    }
+}
+
+void ResourceAllocationModel::invalidateBlocked(const QString &processName)
+{
+    // Symmetric to invalidateChains(): only sets rooted at or containing the holder change.
+    for (auto it = blockedCache.begin(); it != blockedCache.end();) {
+        if (it.key() == processName || it.value().contains(processName))
+            it = blockedCache.erase(it);
+        else
+            ++it;
+    }
+}
+
+BlockingChain ResourceAllocationModel::blockingChain(const QString &processName) const
+{
+    auto cached = chainCache.constFind(processName);
+    if (cached != chainCache.constEnd())
+        return cached.value();
+
+    // Breadth-first walk: process -> requested resource -> holding process.
+    // Anything already in the chain has had its own chain walked or merged in.
+    BlockingChain chain;
+    QList<QString> queue;
+    queue.append(processName);
+    for (int i = 0; i < queue.size(); ++i) {
+        const QString current = queue.at(i);
+        for (const QString &res : requests.value(current)) {
+            if (chain.resources.contains(res))
+                continue;
+            chain.resources.insert(res);
+
+            for (const QString &holder : holders.value(res)) {
+                if (chain.processes.contains(holder))
+                    continue;
+                chain.processes.insert(holder);
+
+                // Reuse a memoized chain instead of walking it again
+                auto sub = chainCache.constFind(holder);
+                if (sub != chainCache.constEnd()) {
+                    chain.processes.unite(sub.value().processes);
+                    chain.resources.unite(sub.value().resources);
+                } else {
+                    queue.append(holder);
+                }
+            }
+        }
     }
-    return QSet<QString>();  // No deadlock detected.
+
+    chainCache.insert(processName, chain);
+    return chain;
+}
+
+QSet<QString> ResourceAllocationModel::blockedBy(const QString &processName) const
+{
+    auto cached = blockedCache.constFind(processName);
+    if (cached != blockedCache.constEnd())
+        return cached.value();
+
+    // Breadth-first walk: process -> allocated resource -> requesting process
+    QSet<QString> blocked;
+    QList<QString> queue;
+    queue.append(processName);
+    for (int i = 0; i < queue.size(); ++i) {
+        const QString current = queue.at(i);
+        for (const QString &res : allocations.value(current)) {
+            for (const QString &waiter : waiters.value(res)) {
+                if (blocked.contains(waiter))
+                    continue;
+                blocked.insert(waiter);
+
+                // Reuse a memoized set instead of walking it again
+                auto sub = blockedCache.constFind(waiter);
+                if (sub != blockedCache.constEnd())
+                    blocked.unite(sub.value());
+                else
+                    queue.append(waiter);
+            }
+        }
+    }
+
+    blockedCache.insert(processName, blocked);
+    return blocked;
+}
+
+// Iterative Tarjan over a dense adjacency list, so large graphs cannot overflow
+// the call stack. Components are numbered in reverse topological order: every
+// edge between two components runs from a higher number to a lower one.
+static int strongComponents(const QVector<QVector<int>> &adjacency, QVector<int> &component)
+{
+    struct Frame { int node; int edge; };
+    const int n = int(adjacency.size());
+    QVector<int> index(n, -1);
+    QVector<int> lowLink(n, 0);
+    QVector<bool> onStack(n, false);
+    QVector<int> stack;
+    QVector<Frame> callStack;
+    int counter = 0;
+    int count = 0;
+    component.fill(-1, n);
+
+    for (int start = 0; start < n; ++start) {
+        if (index[start] >= 0)
+            continue;
+        index[start] = lowLink[start] = counter++;
+        stack.append(start);
+        onStack[start] = true;
+        callStack.append({start, 0});
+
+        while (!callStack.isEmpty()) {
+            const int v = callStack.last().node;
+            if (callStack.last().edge < adjacency[v].size()) {
+                const int w = adjacency[v][callStack.last().edge++];
+                if (index[w] < 0) {
+                    index[w] = lowLink[w] = counter++;
+                    stack.append(w);
+                    onStack[w] = true;
+                    callStack.append({w, 0});
+                } else if (onStack[w]) {
+                    lowLink[v] = qMin(lowLink[v], index[w]);
+                }
+                continue;
+            }
+
+            callStack.removeLast();
+            if (!callStack.isEmpty()) {
+                const int parent = callStack.last().node;
+                lowLink[parent] = qMin(lowLink[parent], lowLink[v]);
+            }
+            if (lowLink[v] != index[v])
+                continue;
+
+            // v is the root of a component: pop it off the stack
+            int w;
+            do {
+                w = stack.takeLast();
+                onStack[w] = false;
+                component[w] = count;
+            } while (w != v);
+            ++count;
+        }
+    }
+    return count;
+}
+
+QStringList ResourceAllocationModel::criticalResources(int k) const
+{
+    // Wait-for graph over processes: p -> q when p requests a resource q holds
+    QHash<QString, int> ids;
+    QVector<QVector<int>> adjacency;
+    auto idOf = [&](const QString &name) {
+        auto found = ids.constFind(name);
+        if (found != ids.constEnd())
+            return found.value();
+        const int id = int(adjacency.size());
+        ids.insert(name, id);
+        adjacency.append(QVector<int>());
+        return id;
+    };
+    for (auto it = requests.constBegin(); it != requests.constEnd(); ++it) {
+        const int waiter = idOf(it.key());
+        for (const QString &res : it.value()) {
+            auto held = holders.constFind(res);
+            if (held == holders.constEnd())
+                continue;
+            for (const QString &holder : held.value()) {
+                const int target = idOf(holder);
+                adjacency[waiter].append(target);
+            }
+        }
+    }
+
+    QVector<int> component;
+    const int count = strongComponents(adjacency, component);
+
+    QVector<QVector<int>> members(count);
+    for (int v = 0; v < component.size(); ++v)
+        members[component[v]].append(v);
+
+    // Condensation with its edges reversed: for each component, the components
+    // that wait on it, each pair recorded once
+    QVector<QVector<int>> waitingOn(count);
+    QVector<int> seen(count, -1);
+    for (int c = 0; c < count; ++c) {
+        for (int v : members[c]) {
+            for (int w : adjacency[v]) {
+                const int d = component[w];
+                if (d == c || seen[d] == c)
+                    continue;
+                seen[d] = c;
+                waitingOn[d].append(c);
+            }
+        }
+    }
+
+    // Score each held resource by the distinct processes it blocks: a
+    // generation-stamped BFS from its waiters' components up the reversed edges
+    QVector<QPair<int, QString>> scores;
+    QVector<int> queue;
+    queue.reserve(count);
+    seen.fill(-1);
+    int stamp = 0;
+    for (auto it = holders.constBegin(); it != holders.constEnd(); ++it) {
+        auto requesting = waiters.constFind(it.key());
+        if (it.value().isEmpty() || requesting == waiters.constEnd())
+            continue;
+
+        ++stamp;
+        queue.clear();
+        for (const QString &waiter : requesting.value()) {
+            const int c = component[ids.value(waiter)];
+            if (seen[c] == stamp)
+                continue;
+            seen[c] = stamp;
+            queue.append(c);
+        }
+
+        int blocked = 0;
+        for (int i = 0; i < queue.size(); ++i) {
+            const int c = queue[i];
+            blocked += int(members[c].size());
+            for (int d : waitingOn[c]) {
+                if (seen[d] == stamp)
+                    continue;
+                seen[d] = stamp;
+                queue.append(d);
+            }
+        }
+        if (blocked > 0)
+            scores.append(qMakePair(blocked, it.key()));
+    }
+
+    // Highest score first, ties broken by name for a stable order
+    k = qBound(0, k, int(scores.size()));
+    std::partial_sort(scores.begin(), scores.begin() + k, scores.end(),
+                      [](const QPair<int, QString> &a, const QPair<int, QString> &b) {
+                          return a.first != b.first ? a.first > b.first : a.second < b.second;
+                      });
+
+    QStringList result;
+    for (int i = 0; i < k; ++i)
+        result.append(scores.at(i).second);
+    return result;
+}
+
+QList<NodeGroup> ResourceAllocationModel::stronglyConnectedGroups() const
+{
+    // Number the nodes: processes first, then resources
+    QVector<QString> names;
+    QHash<QString, int> processIds;
+    QHash<QString, int> resourceIds;
+    for (const QString &proc : processes) {
+        processIds.insert(proc, int(names.size()));
+        names.append(proc);
+    }
+    for (const QString &res : resources) {
+        resourceIds.insert(res, int(names.size()));
+        names.append(res);
+    }
+    const int processTotal = int(processIds.size());
+    const int n = int(names.size());
+
+    // Request edges run process -> resource, allocation edges resource -> process
+    QVector<QVector<int>> adjacency(n);
+    for (auto it = requests.constBegin(); it != requests.constEnd(); ++it) {
+        int from = processIds.value(it.key(), -1);
+        if (from < 0)
+            continue;
+        for (const QString &res : it.value()) {
+            int to = resourceIds.value(res, -1);
+            if (to >= 0)
+                adjacency[from].append(to);
+        }
+    }
+    for (auto it = allocations.constBegin(); it != allocations.constEnd(); ++it) {
+        int to = processIds.value(it.key(), -1);
+        if (to < 0)
+            continue;
+        for (const QString &res : it.value()) {
+            int from = resourceIds.value(res, -1);
+            if (from >= 0)
+                adjacency[from].append(to);
+        }
+    }
+
+    QVector<int> component;
+    const int count = strongComponents(adjacency, component);
+
+    // Only components with more than one node become groups
+    QVector<int> sizes(count, 0);
+    for (int v = 0; v < n; ++v)
+        ++sizes[component[v]];
+
+    QList<NodeGroup> groups;
+    QVector<int> groupOf(count, -1);
+    for (int c = 0; c < count; ++c) {
+        if (sizes[c] < 2)
+            continue;
+        groupOf[c] = int(groups.size());
+        NodeGroup group;
+        group.label = tr("Cycle %1").arg(groups.size() + 1);
+        groups.append(group);
+    }
+    for (int v = 0; v < n; ++v) {
+        const int g = groupOf[component[v]];
+        if (g < 0)
+            continue;
+        if (v < processTotal)
+            groups[g].processes.insert(names[v]);
+        else
+            groups[g].resources.insert(names[v]);
+    }
+    return groups;
+}
+
+QList<NodeGroup> ResourceAllocationModel::prefixGroups(const QString &separator) const
+{
+    if (separator.isEmpty())
+        return QList<NodeGroup>();
+
+    QMap<QString, NodeGroup> byPrefix;
+    for (const QString &proc : processes) {
+        int cut = proc.indexOf(separator);
+        if (cut > 0)
+            byPrefix[proc.left(cut)].processes.insert(proc);
+    }
+    for (const QString &res : resources) {
+        int cut = res.indexOf(separator);
+        if (cut > 0)
+            byPrefix[res.left(cut)].resources.insert(res);
+    }
+
+    QList<NodeGroup> groups;
+    for (auto it = byPrefix.begin(); it != byPrefix.end(); ++it) {
+        if (it.value().processes.size() + it.value().resources.size() < 2)
+            continue;
+        it.value().label = it.key();
+        groups.append(it.value());
+    }
+    return groups;
+}
+
+// Helper to turn a process -> resources map into a JSON object of sorted arrays
+static QJsonObject edgeMapToJson(const QMap<QString, QSet<QString>> &edges)
+{
+    QJsonObject object;
+    for (auto it = edges.constBegin(); it != edges.constEnd(); ++it) {
+        if (it.value().isEmpty())
+            continue;
+        QStringList targets = it.value().values();
+        targets.sort();
+        object.insert(it.key(), QJsonArray::fromStringList(targets));
+    }
+    return object;
+}
+
+QJsonObject ResourceAllocationModel::toJson() const
+{
+    QStringList processList = processes.values();
+    QStringList resourceList = resources.values();
+    processList.sort();
+    resourceList.sort();
+
+    QJsonObject object;
+    object.insert("processes", QJsonArray::fromStringList(processList));
+    object.insert("resources", QJsonArray::fromStringList(resourceList));
+    object.insert("requests", edgeMapToJson(requests));
+    object.insert("allocations", edgeMapToJson(allocations));
+    return object;
 }
@@ -5,6 +5,30 @@
 #include <QString>
 #include <QSet>
 #include <QMap>
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+#include <QDataStream>
+#include <QJsonObject>
+
+/**
+ * @brief A set of processes and resources that is displayed as one super-node.
+ */
+struct NodeGroup
+{
+    QString label;
+    QSet<QString> processes;
+    QSet<QString> resources;
+};
+
+/**
+ * @brief The processes and resources a process transitively waits on.
+ */
+struct BlockingChain
+{
+    QSet<QString> processes;
+    QSet<QString> resources;
+};
 
 /**
  * @brief The ResourceAllocationModel class
@@ -40,9 +64,92 @@ public:
      */
     QSet<QString> detectDeadlockCycle() const;
 
+    /**
+     * @brief Checks for a deadlock without building the cycle.
+     * Walks id-based edges with the model's reusable scratch space, so it makes
+     * no heap allocations.
+     * @return true if the graph contains a deadlock cycle.
+     */
+    bool hasDeadlock() const;
+
+    /**
+     * @brief Everything a process transitively waits on.
+     * Follows request edges to resources and allocation edges on to their holders.
+     * Results are memoized until an edge on the chain changes.
+     * @param processName The waiting process.
+     * @return The resources and processes in the chain; the process itself is
+     *         only included if it is part of a cycle.
+     */
+    BlockingChain blockingChain(const QString &processName) const;
+
+    /**
+     * @brief Processes that transitively wait on a process.
+     * Results are memoized until an edge on the chain changes.
+     * @param processName The blocking process.
+     * @return Names of the blocked processes.
+     */
+    QSet<QString> blockedBy(const QString &processName) const;
+
+    /**
+     * @brief Resources that block the most processes, directly or transitively.
+     * Each resource is scored by the number of distinct processes waiting on it,
+     * found by a walk over the condensed wait-for graph.
+     * @param k Maximum number of resources to return.
+     * @return Resource names, most critical first; resources blocking nothing are omitted.
+     */
+    QStringList criticalResources(int k) const;
+
+    /**
+     * @brief Strongly connected components of the allocation graph.
+     * Only components with more than one node are returned; every cycle in the
+     * graph lies entirely inside one of them.
+     */
+    QList<NodeGroup> stronglyConnectedGroups() const;
+
+    /**
+     * @brief Group processes and resources by the part of their name before a separator.
+     * Names without the separator, and prefixes shared by a single node, are left ungrouped.
+     * @param separator The separator, e.g. "." groups "db.reader" with "db.lock".
+     */
+    QList<NodeGroup> prefixGroups(const QString &separator) const;
+
+    /**
+     * @brief Remove every process, resource, request and allocation.
+     */
+    void clear();
+
+    /**
+     * @brief Serialize the model to a binary stream.
+     * @param out The stream to write to.
+     */
+    void save(QDataStream &out) const;
+
+    /**
+     * @brief Replace the model with one read from a binary stream.
+     * @param in The stream to read from.
+     * @return false if the stream is truncated or corrupt; the model is left unchanged.
+     */
+    bool load(QDataStream &in);
+
+    /**
+     * @brief Replace the model's contents with those of another model.
+     * Indexes and caches are moved along rather than rebuilt.
+     * @param other The model to take from; it receives this model's old contents.
+     */
+    void takeFrom(ResourceAllocationModel &other);
+
+    /**
+     * @brief Export the model as a JSON object.
+     */
+    QJsonObject toJson() const;
+
     // Accessors
+    bool hasProcess(const QString &processName) const { return processes.contains(processName); }
+    bool hasResource(const QString &resourceName) const { return resources.contains(resourceName); }
     QSet<QString> getProcesses() const { return processes; }
     QSet<QString> getResources() const { return resources; }
+    QMap<QString, QSet<QString>> getRequests() const { return requests; }
+    QMap<QString, QSet<QString>> getAllocations() const { return allocations; }
 
 private:
     QSet<QString> processes;
@@ -50,15 +157,79 @@ private:
     QMap<QString, QSet<QString>> requests;
     QMap<QString, QSet<QString>> allocations;
 
+    // Reverse indexes keyed by resource name
+    QMap<QString, QSet<QString>> holders;   // processes the resource is allocated to
+    QMap<QString, QSet<QString>> waiters;   // processes requesting the resource
+
+    // Memoized reachability, keyed by process name
+    mutable QHash<QString, BlockingChain> chainCache;
+    mutable QHash<QString, QSet<QString>> blockedCache;
+
+    /**
+     * @brief Rebuild the reverse indexes and detection ids from requests and
+     * allocations and drop everything memoized from the old edges.
+     */
+    void rebuildIndexes();
+
+    /**
+     * @brief Drop memoized chains that start at or pass through a waiting process.
+     */
+    void invalidateChains(const QString &processName);
+
+    /**
+     * @brief Drop memoized blocked sets that start at or are reached through a holding process.
+     */
+    void invalidateBlocked(const QString &processName);
+
+    /**
+     * @brief One level of the iterative deadlock DFS: the process being expanded,
+     * the next of its requests to follow, and the next holder of the current one.
+     */
+    struct DetectionFrame
+    {
+        int process = 0;
+        int request = 0;
+        int resource = -1;
+        int holder = 0;
+    };
+
+    // Dense ids and id-based edges for deadlock detection. Ids are handed out as
+    // names first appear and never renumbered; ids of removed processes and
+    // resources go on a free list and are reused, so the arrays stay as large
+    // as the peak live graph rather than every name ever seen.
+    QHash<QString, int> processIndex;
+    QVector<QString> indexedProcesses;
+    QVector<bool> rootProcess;
+    QVector<QVector<int>> requestedIds;   // process id -> requested resource ids
+    QVector<int> freeProcessIds;
+    QHash<QString, int> resourceIndex;
+    QVector<QVector<int>> holderIds;      // resource id -> holding process ids
+    QVector<int> freeResourceIds;
+
+    // Deadlock-detection scratch space, one slot per process id and grown with
+    // the ids. A visit counts for the current run only if its stamp equals the
+    // current generation.
+    mutable QVector<quint32> visitedStamp;
+    mutable QVector<quint32> onStackStamp;
+    mutable QVector<DetectionFrame> scratchStack;
+    mutable quint32 generation = 0;
+
+    /**
+     * @brief Id of a process name, assigning the next free one if it is new.
+     */
+    int processId(const QString &processName);
+
+    /**
+     * @brief Id of a resource name, assigning the next free one if it is new.
+     */
+    int resourceId(const QString &resourceName);
+
     /**
-     * @brief Helper function to perform DFS for deadlock detection.
-     * @param process The current process.
-     * @param visited Set of visited processes.
-     * @param recStack Current recursion stack.
-     * @param cycle Set capturing the processes forming the cycle.
-     * @return true if a cycle is found, false otherwise.
+     * @brief Iterative DFS over the wait-for graph using the scratch space.
+     * @return Index into scratchStack where the cycle starts, or -1 if there is none.
+     *         On success, the cycle is scratchStack[index .. depth - 1].
      */
-    bool dfs(const QString &process, QSet<QString> &visited, QSet<QString> &recStack, QSet<QString> &cycle) const;
+    int findCycle(int &depth) const;
 };
 
 #endif // RESOURCEALLOCATIONMODEL_H